@@ -0,0 +1,285 @@
+#ifndef ASYNCQUERY_H
+#define ASYNCQUERY_H
+
+#include <vector>
+#include <string>
+#include <deque>
+#include <memory>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <coroutine>
+#include "HospitalGraph.h"
+#include "HospitalRecommender.h"
+
+using namespace std;
+
+// ===================================================================
+// FEATURE 6: Async Queries (C++20 Coroutines + Time Slices)
+// ===================================================================
+
+// A long search is written as a coroutine that suspends after every
+// "slice" (a fixed number of settled nodes). AsyncQueryEngine resumes the
+// pending queries one slice at a time, so the caller (e.g. the browser's
+// main thread) gets control back between slices and can cancel queries
+// that are no longer needed. Requires -std=c++20.
+
+enum QueryStatus {
+    QUERY_PENDING,
+    QUERY_DONE,
+    QUERY_CANCELLED
+};
+
+// Copies share the same flag, so the UI can keep one and the engine another
+class CancellationToken {
+private:
+    shared_ptr<atomic<bool>> flag = make_shared<atomic<bool>>(false);
+
+public:
+    void cancel() const { flag->store(true); }
+    bool isCancelled() const { return flag->load(); }
+};
+
+// Called at the end of every slice with a 0..1 estimate
+typedef function<void(double)> ProgressCallback;
+
+template <typename T>
+struct QueryOutcome {
+    QueryStatus status;
+    T value; // Empty/default when cancelled
+};
+
+// State shared by the coroutine, the engine and the caller's handle
+template <typename T>
+struct QueryShared {
+    QueryStatus status = QUERY_PENDING;
+    promise<QueryOutcome<T>> result;
+    shared_future<QueryOutcome<T>> future = result.get_future().share();
+    vector<function<void(const QueryOutcome<T>&)>> listeners;
+
+    // The future is made ready before any listener runs, so a listener may
+    // call getFuture().get() or onComplete() without blocking.
+    void finish(QueryStatus finalStatus, T value) {
+        if (status != QUERY_PENDING) return;
+        status = finalStatus;
+        QueryOutcome<T> outcome{finalStatus, std::move(value)};
+        result.set_value(outcome);
+        vector<function<void(const QueryOutcome<T>&)>> toNotify;
+        toNotify.swap(listeners);
+        for (auto& listener : toNotify) listener(outcome);
+    }
+};
+
+// What the caller gets back: a future for native code, onComplete for
+// callback style (used by the JS bindings), and cancel().
+template <typename T>
+class QueryHandle {
+private:
+    shared_ptr<QueryShared<T>> shared;
+    CancellationToken token;
+
+public:
+    QueryHandle(shared_ptr<QueryShared<T>> s, CancellationToken t) : shared(s), token(t) {}
+
+    void cancel() const { token.cancel(); }
+    QueryStatus getStatus() const { return shared->status; }
+    const CancellationToken& getToken() const { return token; }
+
+    // Ready once the engine has run the query to completion (or dropped it)
+    shared_future<QueryOutcome<T>> getFuture() const { return shared->future; }
+
+    // Runs right away if the query has already finished
+    void onComplete(function<void(const QueryOutcome<T>&)> listener) const {
+        if (shared->status == QUERY_PENDING) {
+            shared->listeners.push_back(listener);
+        } else {
+            listener(shared->future.get());
+        }
+    }
+};
+
+// Minimal coroutine type: starts suspended, suspends at the end so the
+// engine can see it finished, and destroys its frame (with every buffer
+// the search allocated) when the task object goes away.
+class SlicedTask {
+public:
+    struct promise_type {
+        promise_type() { liveCount()++; }
+        ~promise_type() { liveCount()--; }
+
+        SlicedTask get_return_object() {
+            return SlicedTask(coroutine_handle<promise_type>::from_promise(*this));
+        }
+        suspend_always initial_suspend() noexcept { return {}; }
+        suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { terminate(); }
+    };
+
+    // Number of coroutine frames currently alive (for tests / leak checks)
+    static atomic<int>& liveCount() {
+        static atomic<int> count(0);
+        return count;
+    }
+
+    explicit SlicedTask(coroutine_handle<promise_type> h) : handle(h) {}
+    SlicedTask(SlicedTask&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+    SlicedTask& operator=(SlicedTask&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = other.handle;
+            other.handle = nullptr;
+        }
+        return *this;
+    }
+    SlicedTask(const SlicedTask&) = delete;
+    SlicedTask& operator=(const SlicedTask&) = delete;
+    ~SlicedTask() {
+        if (handle) handle.destroy();
+    }
+
+    // Runs one slice; returns true when the coroutine has finished
+    bool resume() {
+        handle.resume();
+        return handle.done();
+    }
+
+private:
+    coroutine_handle<promise_type> handle;
+};
+
+class AsyncQueryEngine {
+private:
+    struct Entry {
+        SlicedTask task;
+        CancellationToken token;
+        function<void()> finishCancelled;
+    };
+
+    deque<Entry> queue; // round-robin: one slice per query per turn
+    int nodesPerSlice;
+
+    // Share of the graph settled so far (0..1)
+    static double searchProgress(const SearchState& state) {
+        return state.dist.empty() ? 1.0 : (double)state.settled / state.dist.size();
+    }
+
+    // ---- Coroutines (one per query kind) ----
+    // Arguments are copied into the coroutine frame; graph and recommender
+    // must outlive the query.
+
+    template <typename Policy>
+    static SlicedTask recommendationsTask(string area, const AreaGraph* graph,
+                                          const BasicHospitalRecommender<Policy>* recommender,
+                                          shared_ptr<QueryShared<vector<HospitalScoreWrapper>>> shared,
+                                          ProgressCallback progress, int budget) {
+        int startId = graph->getNodeId(area);
+        if (startId == -1 || recommender->canUseMatrix(*graph)) {
+            // Unknown area, or the matrix answers instantly: no search needed
+            SearchState unused;
+            shared->finish(QUERY_DONE, recommender->getRecommendations(area, *graph, unused));
+            co_return;
+        }
+
+        SearchState state; // Lives in the frame, freed when the task is dropped
+        graph->startSearch(startId, state);
+        while (!graph->stepSearch(state, false, budget)) {
+            if (progress) progress(searchProgress(state));
+            co_await suspend_always{};
+        }
+        if (progress) progress(1.0);
+        shared->finish(QUERY_DONE, recommender->rankDistances(*graph, state.dist));
+    }
+
+    static SlicedTask nearestHospitalTask(string area, const AreaGraph* graph,
+                                          shared_ptr<QueryShared<PathResult>> shared,
+                                          ProgressCallback progress, int budget) {
+        int startId = graph->getNodeId(area);
+        if (startId == -1) {
+            shared->finish(QUERY_DONE, {"Unknown Area", -1, {}});
+            co_return;
+        }
+
+        SearchState state;
+        graph->startSearch(startId, state);
+        while (!graph->stepSearch(state, true, budget)) {
+            if (progress) progress(searchProgress(state));
+            co_await suspend_always{};
+        }
+        if (progress) progress(1.0);
+
+        int hospId = state.foundHospital;
+        if (hospId == -1) {
+            shared->finish(QUERY_DONE, {"No Hospital Found", -1, {}});
+            co_return;
+        }
+
+        vector<string> path;
+        for (int curr = hospId; curr != -1; curr = state.parent[curr]) {
+            path.push_back(graph->getNodeName(curr));
+        }
+        reverse(path.begin(), path.end());
+        shared->finish(QUERY_DONE, {graph->getNodeName(hospId), state.dist[hospId], path});
+    }
+
+    template <typename T>
+    QueryHandle<T> enqueue(SlicedTask task, shared_ptr<QueryShared<T>> shared, CancellationToken token) {
+        queue.push_back({std::move(task), token, [shared]() { shared->finish(QUERY_CANCELLED, T()); }});
+        return QueryHandle<T>(shared, token);
+    }
+
+public:
+    // nodesPerSlice: how many nodes a query may settle before yielding
+    explicit AsyncQueryEngine(int nodesPerSlice = 2048) : nodesPerSlice(nodesPerSlice) {}
+
+    template <typename Policy>
+    QueryHandle<vector<HospitalScoreWrapper>> getRecommendationsAsync(
+            const string& area, const AreaGraph& graph, const BasicHospitalRecommender<Policy>& recommender,
+            ProgressCallback progress = nullptr, CancellationToken token = CancellationToken()) {
+        auto shared = make_shared<QueryShared<vector<HospitalScoreWrapper>>>();
+        return enqueue(recommendationsTask(area, &graph, &recommender, shared, progress, nodesPerSlice), shared, token);
+    }
+
+    QueryHandle<PathResult> findNearestHospitalAsync(
+            const string& area, const AreaGraph& graph,
+            ProgressCallback progress = nullptr, CancellationToken token = CancellationToken()) {
+        auto shared = make_shared<QueryShared<PathResult>>();
+        return enqueue(nearestHospitalTask(area, &graph, shared, progress, nodesPerSlice), shared, token);
+    }
+
+    // Runs one slice of the next pending query. Cancelled queries are not
+    // resumed at all: wherever they sit in the queue, they are completed as
+    // QUERY_CANCELLED and their coroutine frames (search buffers included)
+    // are destroyed here first. Returns false if there was nothing to do.
+    bool runSlice() {
+        bool didWork = false;
+        for (auto it = queue.begin(); it != queue.end();) {
+            if (it->token.isCancelled()) {
+                Entry cancelled = std::move(*it);
+                it = queue.erase(it);
+                cancelled.finishCancelled();
+                didWork = true;
+            } else {
+                ++it;
+            }
+        }
+        if (queue.empty()) return didWork;
+
+        Entry entry = std::move(queue.front());
+        queue.pop_front();
+        if (!entry.task.resume()) {
+            queue.push_back(std::move(entry));
+        }
+        return true;
+    }
+
+    void runUntilIdle() {
+        while (runSlice()) {}
+    }
+
+    int getPendingCount() const { return queue.size(); }
+
+    static int getLiveTaskCount() { return SlicedTask::liveCount().load(); }
+};
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef COVERAGEPLANNER_H
+#define COVERAGEPLANNER_H
+
+#include <vector>
+#include <string>
+#include <chrono>
+#include "HospitalGraph.h"
+#include "HospitalRecommender.h"
+#include "ThreadPool.h"
+
+using namespace std;
+
+// ==================================================================
+// FEATURE 5: Coverage Map (Batch Dijkstra on a Work-Stealing Pool)
+// ==================================================================
+
+// Nearest hospital + full ranking for one area
+struct CoverageEntry {
+    string area;
+    PathResult nearest;
+    vector<HospitalScoreWrapper> recommendations;
+};
+
+struct CoverageReport {
+    vector<CoverageEntry> entries; // Same order as the input areas
+    int workers;
+    double parallelMs;
+    double sequentialMs; // 0 if the sequential run was skipped
+    double speedup;      // sequentialMs / parallelMs (0 if skipped)
+};
+
+class CoveragePlanner {
+private:
+    WorkStealingPool& pool;
+    vector<SearchState> workerStates; // one reusable SearchState per worker
+
+    template <typename Policy>
+    static void fillEntry(CoverageEntry& entry, const string& area, const AreaGraph& graph,
+                          const BasicHospitalRecommender<Policy>& recommender, SearchState& state) {
+        entry.area = area;
+        entry.nearest = graph.findNearestHospital(area, state);
+        entry.recommendations = recommender.getRecommendations(area, graph, state);
+    }
+
+public:
+    explicit CoveragePlanner(WorkStealingPool& workerPool = sharedWorkerPool()) : pool(workerPool) {
+        workerStates.resize(pool.getWorkerCount());
+    }
+
+    // Runs findNearestHospital + getRecommendations for every area.
+    // If measureSpeedup is set, the same work is also done in a plain
+    // sequential loop so the report can show the speedup.
+    template <typename Policy>
+    CoverageReport buildCoverage(const vector<string>& areas, AreaGraph& graph,
+                                 BasicHospitalRecommender<Policy>& recommender, bool measureSpeedup = false) {
+        // Matrix updates write shared data, so do them once up front
+        recommender.refreshDistanceMatrix(graph);
+
+        CoverageReport report;
+        report.workers = pool.getWorkerCount();
+        report.entries.resize(areas.size());
+
+        auto start = chrono::steady_clock::now();
+        pool.run(areas.size(), [&](int worker, int task) {
+            fillEntry(report.entries[task], areas[task], graph, recommender, workerStates[worker]);
+        });
+        auto end = chrono::steady_clock::now();
+        report.parallelMs = chrono::duration<double, milli>(end - start).count();
+
+        report.sequentialMs = 0;
+        report.speedup = 0;
+        if (measureSpeedup) {
+            vector<CoverageEntry> check(areas.size());
+            SearchState state;
+            start = chrono::steady_clock::now();
+            for (size_t i = 0; i < areas.size(); i++) {
+                fillEntry(check[i], areas[i], graph, recommender, state);
+            }
+            end = chrono::steady_clock::now();
+            report.sequentialMs = chrono::duration<double, milli>(end - start).count();
+            if (report.parallelMs > 0) report.speedup = report.sequentialMs / report.parallelMs;
+        }
+        return report;
+    }
+};
+
+#endif
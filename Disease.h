@@ -5,6 +5,9 @@
 #include <vector>
 #include <iostream>
 #include <algorithm>
+#include <string_view>
+#include "StringPool.h"
+#include "MemoryReport.h"
 
 using namespace std;
 
@@ -12,15 +15,17 @@ using namespace std;
 // FEATURE 1: Linked List for Disease Storage
 // ==========================================
 
+// All text lives in the owning DiseaseList's StringPool; the node only
+// holds views into it, so a disease is a single small allocation.
 struct Disease {
-    string name;
-    string description;
-    vector<string> symptoms;
-    vector<string> preventions;
+    string_view name;
+    string_view description;
+    StringList symptoms;
+    StringList preventions;
     int severity; // 1-10 scale
     Disease* next;
 
-    Disease(string n, string desc, vector<string> sym, vector<string> prev, int sev) {
+    Disease(string_view n, string_view desc, StringList sym, StringList prev, int sev) {
         name = n;
         description = desc;
         symptoms = sym;
@@ -33,15 +38,28 @@ struct Disease {
 class DiseaseList {
 private:
     Disease* head;
+    int count;
+    StringPool pool; // Shared, deduplicated text for every disease
 
 public:
     DiseaseList() {
         head = nullptr;
+        count = 0;
+    }
+
+    ~DiseaseList() {
+        while (head != nullptr) {
+            Disease* next = head->next;
+            delete head;
+            head = next;
+        }
     }
 
     // Add a disease to the end of the Linked List
     void addDisease(string name, string desc, vector<string> sym, vector<string> prev, int sev) {
-        Disease* newNode = new Disease(name, desc, sym, prev, sev);
+        Disease* newNode = new Disease(pool.get(pool.intern(name)), pool.pack(desc),
+                                       pool.internList(sym), pool.internList(prev), sev);
+        count++;
         if (head == nullptr) {
             head = newNode;
         } else {
@@ -142,6 +160,15 @@ public:
     
     // Helper to get raw pointer for Bindings (optional use)
     Disease* getHead() { return head; }
+
+    int getCount() const { return count; }
+
+    const StringPool& getStringPool() const { return pool; }
+
+    // Nodes + all of their text
+    size_t memoryUsage() const {
+        return count * sizeof(Disease) + pool.memoryUsage();
+    }
 };
 
 #endif
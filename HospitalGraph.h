@@ -8,6 +8,7 @@
 #include <queue>
 #include <climits>
 #include <algorithm>
+#include "MemoryReport.h"
 
 using namespace std;
 
@@ -21,6 +22,31 @@ struct Edge {
     double distance; // Changed to double for precision
 };
 
+// Same edge, but pointing at a numeric node id instead of a name.
+// Used by the fast (integer based) Dijkstra below.
+struct IndexedEdge {
+    int target;
+    double distance;
+};
+
+// One entry per addRoad call, so other components can see which roads
+// were added since they last looked at the graph.
+struct RoadRecord {
+    int u;
+    int v;
+    double distance;
+};
+
+// Scratch buffers for one Dijkstra run. Keeping one of these per thread
+// and passing it in lets repeated searches reuse the same memory.
+struct SearchState {
+    vector<double> dist;
+    vector<int> parent;
+    vector<pair<double, int>> heap; // storage for the min-heap (push_heap/pop_heap)
+    int settled = 0;                // nodes popped with their final distance
+    int foundHospital = -1;         // set by a stopAtHospital search
+};
+
 // Return structure for the Frontend
 struct PathResult {
     string hospitalName;
@@ -36,21 +62,59 @@ private:
     // List of known hospitals to check against
     vector<string> hospitalLocations;
 
+    // Indexed copy of the same graph: every node gets a number 0..N-1.
+    // Searches over ints avoid string hashing and are safe to run from
+    // several threads at once (nothing is modified while searching).
+    vector<string> nodeNames;
+    unordered_map<string, int> nodeIds;
+    vector<vector<IndexedEdge>> indexedAdj;
+    vector<RoadRecord> roadLog;
+    vector<char> isHospitalId; // 1 if node id is one of hospitalLocations
+
+    int getOrCreateId(const string& name) {
+        auto it = nodeIds.find(name);
+        if (it != nodeIds.end()) return it->second;
+        int id = nodeNames.size();
+        nodeIds[name] = id;
+        nodeNames.push_back(name);
+        indexedAdj.push_back({});
+        bool isHosp = find(hospitalLocations.begin(), hospitalLocations.end(), name) != hospitalLocations.end();
+        isHospitalId.push_back(isHosp ? 1 : 0);
+        return id;
+    }
+
+    // Shared core of the SearchState searches below. Stops early at the
+    // first hospital popped when stopAtHospital is set; returns its id (or -1).
+    int runSearch(int startId, SearchState& state, bool stopAtHospital) const {
+        startSearch(startId, state);
+        stepSearch(state, stopAtHospital, INT_MAX);
+        return state.foundHospital;
+    }
+
 public:
     void addArea(string areaName) {
         // Just ensures the key exists
         if (adjList.find(areaName) == adjList.end()) {
             adjList[areaName] = {};
         }
+        getOrCreateId(areaName);
     }
 
     void addRoad(string u, string v, double dist) {
         adjList[u].push_back({v, dist});
         adjList[v].push_back({u, dist}); // Undirected graph (road goes both ways)
+
+        int uId = getOrCreateId(u);
+        int vId = getOrCreateId(v);
+        indexedAdj[uId].push_back({vId, dist});
+        indexedAdj[vId].push_back({uId, dist});
+        roadLog.push_back({uId, vId, dist});
     }
 
     void addHospitalLocation(string areaName) {
         hospitalLocations.push_back(areaName);
+        int id = getNodeId(areaName);
+        if (id != -1) isHospitalId[id] = 1;
     }
     
     void setupIslamabadMap() {
@@ -210,6 +274,121 @@ public:
         return dist;
     }
     
+    // ---- Indexed helpers ----
+
+    int getNodeCount() const { return nodeNames.size(); }
+
+    // Returns -1 if the name is not in the graph
+    int getNodeId(const string& name) const {
+        auto it = nodeIds.find(name);
+        return it == nodeIds.end() ? -1 : it->second;
+    }
+
+    const string& getNodeName(int id) const { return nodeNames[id]; }
+
+    bool isHospitalNode(int id) const { return isHospitalId[id] != 0; }
+
+    const vector<IndexedEdge>& getIndexedNeighbors(int id) const { return indexedAdj[id]; }
+
+    // Every road ever added, in insertion order
+    const vector<RoadRecord>& getRoadLog() const { return roadLog; }
+
+    // ---- Resumable Dijkstra (used by runSearch and the async queries) ----
+
+    // Resets 'state' for a search starting at startId
+    void startSearch(int startId, SearchState& state) const {
+        int n = nodeNames.size();
+        state.dist.assign(n, 1e9);
+        state.parent.assign(n, -1);
+        state.heap.clear();
+        state.settled = 0;
+        state.foundHospital = -1;
+        state.dist[startId] = 0.0;
+        state.heap.push_back({0.0, startId});
+    }
+
+    // Settles up to 'budget' nodes and returns true when the search is over,
+    // so a long search can be split into slices. Nodes added to the graph
+    // after startSearch are ignored.
+    bool stepSearch(SearchState& state, bool stopAtHospital, int budget) const {
+        int n = state.dist.size();
+        auto cmp = greater<pair<double, int>>();
+        while (!state.heap.empty() && budget > 0) {
+            pop_heap(state.heap.begin(), state.heap.end(), cmp);
+            double d = state.heap.back().first;
+            int u = state.heap.back().second;
+            state.heap.pop_back();
+
+            if (d > state.dist[u]) continue;
+            state.settled++;
+            budget--;
+            if (stopAtHospital && isHospitalId[u]) {
+                state.foundHospital = u;
+                state.heap.clear();
+                return true;
+            }
+
+            for (const auto& edge : indexedAdj[u]) {
+                if (edge.target >= n) continue;
+                if (d + edge.distance < state.dist[edge.target]) {
+                    state.dist[edge.target] = d + edge.distance;
+                    state.parent[edge.target] = u;
+                    state.heap.push_back({state.dist[edge.target], edge.target});
+                    push_heap(state.heap.begin(), state.heap.end(), cmp);
+                }
+            }
+        }
+        return state.heap.empty();
+    }
+
+    // Same Dijkstra as getShortestPaths, but over node ids, reusing the
+    // caller's SearchState. state.dist gets one entry per node (1e9 =
+    // unreachable). Only reads the graph, so several threads can call it.
+    void shortestDistancesFrom(int startId, SearchState& state) const {
+        if (startId < 0 || startId >= (int)nodeNames.size()) {
+            state.dist.assign(nodeNames.size(), 1e9);
+            return;
+        }
+        runSearch(startId, state, false);
+    }
+
+    // Thread-safe version of findNearestHospital (same results), reusing
+    // the caller's SearchState instead of allocating maps each time.
+    PathResult findNearestHospital(const string& startNode, SearchState& state) const {
+        int startId = getNodeId(startNode);
+        if (startId == -1) {
+            return {"Unknown Area", -1, {}};
+        }
+
+        int hospId = runSearch(startId, state, true);
+        if (hospId == -1) {
+            return {"No Hospital Found", -1, {}};
+        }
+
+        vector<string> path;
+        for (int curr = hospId; curr != -1; curr = state.parent[curr]) {
+            path.push_back(nodeNames[curr]);
+        }
+        reverse(path.begin(), path.end());
+
+        return {nodeNames[hospId], state.dist[hospId], path};
+    }
+
+    // Heap bytes of the named graph, its indexed copy and the road log
+    size_t memoryUsage() const {
+        size_t total = heapBytes(adjList);
+        for (const auto& entry : adjList) {
+            total += heapBytes(entry.first) + heapBytes(entry.second);
+            for (const auto& edge : entry.second) total += heapBytes(edge.targetNode);
+        }
+        total += heapBytes(hospitalLocations);
+        total += heapBytes(nodeNames) + heapBytes(nodeIds) + heapBytes(indexedAdj);
+        for (const auto& entry : nodeIds) total += heapBytes(entry.first);
+        for (const auto& edges : indexedAdj) total += heapBytes(edges);
+        total += heapBytes(roadLog) + heapBytes(isHospitalId);
+        return total;
+    }
+
     vector<string> getAreas() {
         vector<string> areas;
         for(auto const& [key, val] : adjList) {
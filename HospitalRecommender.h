@@ -5,6 +5,9 @@
 #include <string>
 #include <queue>
 #include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
 
 using namespace std;
 
@@ -16,14 +19,7 @@ struct HospitalData {
     string name;
     string locationNode; // Node name in the AreaGraph
     string fullLocation; // Human readable location
-    double rating;       // 1-5 (User provided)
-
-    // Custom Score Calculation
-    // Score = Distance + (5.0 - Rating)
-    // LOWER score is BETTER.
-    double getScore(double distance) const {
-        return distance + (5.0 - rating);
-    }
+    // The rating (1-5, user provided) lives in the recommender's status table
 };
 
 // Wrapper for Priority Queue
@@ -31,6 +27,7 @@ struct HospitalScoreWrapper {
     HospitalData data;
     double score;
     double realDistance;
+    double rating;
 
     // We want Min Heap based on score.
     bool operator>(const HospitalScoreWrapper& other) const {
@@ -39,47 +36,396 @@ struct HospitalScoreWrapper {
 };
 
 #include "HospitalGraph.h" // Include to use AreaGraph
+#include "ThreadPool.h"    // Parallel distance matrix builds
+
+// ---- Live hospital status ----
+
+// Bit flags for HospitalStatusTable::flags
+enum HospitalFlag : uint8_t {
+    HOSP_CARDIAC_UNIT = 1, // Has a dedicated cardiac / cath lab unit
+    HOSP_ER_OPEN      = 2  // Emergency room currently accepting patients
+};
+
+// One streamed status message (e.g. from a hospital's feed)
+struct HospitalStatusUpdate {
+    string hospitalName;
+    int availableBeds;  // -1 = unknown
+    float waitMinutes;  // Current ER wait time
+    uint8_t flags;      // HospitalFlag bits
+};
+
+// Per-hospital numbers stored column by column (struct of arrays), indexed
+// like the recommender's db. This is the only place a hospital's rating is
+// kept. 'penalty' caches the distance-independent part of the score; the
+// recommender recomputes it whenever the rating or status of that hospital
+// changes, so the ranking loop only has to read distance + penalty.
+// Rating, penalty and score stay double like the original formula (a 3.8
+// rating still prints as 3.8); only the matrix distances are float.
+struct HospitalStatusTable {
+    vector<double> rating;
+    vector<int> availableBeds;
+    vector<float> waitMinutes;
+    vector<uint8_t> flags;
+    vector<double> penalty;
+
+    int size() const { return rating.size(); }
+
+    void push(double r) {
+        rating.push_back(r);
+        availableBeds.push_back(-1);
+        waitMinutes.push_back(0.0f);
+        flags.push_back(HOSP_ER_OPEN);
+        penalty.push_back(0.0);
+    }
+};
+
+// ---- Scoring policies ----
+// A policy is a template argument of BasicHospitalRecommender, so its
+// formula gets inlined (no virtual calls). It has two static functions:
+//   penalty(t, h)         - the part that does not depend on distance,
+//                           evaluated once per rating/status update
+//   score(distance, t, h) - evaluated in the ranking loop
+// LOWER score is BETTER.
 
-class HospitalRecommender {
+// The original formula: Distance + (5.0 - Rating). Ignores live status.
+struct DistanceRatingScore {
+    static inline double penalty(const HospitalStatusTable& t, int h) {
+        return 5.0 - t.rating[h];
+    }
+    static inline double score(double distance, const HospitalStatusTable& t, int h) {
+        return distance + t.penalty[h];
+    }
+};
+
+// Distance + rating, plus live status:
+//   + 1 point per 10 minutes of ER wait
+//   + 25 points if the ER is closed or there are no free beds
+//   - 2 points for a cardiac unit
+// All of that is folded into the penalty, so the ranking loop costs the
+// same as DistanceRatingScore's.
+struct CapacityAwareScore {
+    static inline double penalty(const HospitalStatusTable& t, int h) {
+        bool full = t.availableBeds[h] == 0 || !(t.flags[h] & HOSP_ER_OPEN);
+        bool cardiac = t.flags[h] & HOSP_CARDIAC_UNIT;
+        return (5.0 - t.rating[h]) + t.waitMinutes[h] * 0.1
+             + (full ? 25.0 : 0.0) - (cardiac ? 2.0 : 0.0);
+    }
+    static inline double score(double distance, const HospitalStatusTable& t, int h) {
+        return distance + t.penalty[h];
+    }
+};
+
+template <typename ScoringPolicy>
+class BasicHospitalRecommender {
 private:
     vector<HospitalData> db;
+    HospitalStatusTable status;          // Same order as db
+    unordered_map<string, int> nameIndex; // Hospital name -> db index
+
+    // ---- Optional precomputed distance matrix ----
+    // distMatrix[node * H + h] = road distance from graph node to hospital h
+    // (H = db.size(), h follows db order). One float row per area, so a
+    // recommendation only has to read a single row.
+    bool useMatrix = false;
+    AreaGraph* matrixGraph = nullptr;
+    int matrixRows = 0;
+    size_t matrixRoadsSeen = 0;  // how much of graph.getRoadLog() is already applied
+    vector<int> hospNodeIds;     // graph node id of each db entry (-1 if not on the map)
+    vector<float> distMatrix;
+
+    // A new road can only make paths shorter, so instead of recomputing
+    // everything we push the improvement outwards from the road's two ends,
+    // one hospital column at a time.
+    void relaxNewRoad(const AreaGraph& graph, const RoadRecord& road) {
+        int H = db.size();
+        priority_queue<pair<float, int>, vector<pair<float, int>>, greater<pair<float, int>>> pq;
+
+        for (int h = 0; h < H; h++) {
+            float* col = distMatrix.data() + h; // column h, stride H
+
+            float viaU = (float)(col[(size_t)road.u * H] + road.distance);
+            float viaV = (float)(col[(size_t)road.v * H] + road.distance);
+            if (viaU < col[(size_t)road.v * H]) {
+                col[(size_t)road.v * H] = viaU;
+                pq.push({viaU, road.v});
+            }
+            if (viaV < col[(size_t)road.u * H]) {
+                col[(size_t)road.u * H] = viaV;
+                pq.push({viaV, road.u});
+            }
+
+            while (!pq.empty()) {
+                float d = pq.top().first;
+                int u = pq.top().second;
+                pq.pop();
+
+                if (d > col[(size_t)u * H]) continue;
+
+                for (const auto& edge : graph.getIndexedNeighbors(u)) {
+                    float nd = (float)(d + edge.distance);
+                    if (nd < col[(size_t)edge.target * H]) {
+                        col[(size_t)edge.target * H] = nd;
+                        pq.push({nd, edge.target});
+                    }
+                }
+            }
+        }
+    }
+
+    // Bring the matrix up to date with areas/roads added since the last build
+    void syncDistanceMatrix(AreaGraph& graph) {
+        const vector<RoadRecord>& log = graph.getRoadLog();
+        int N = graph.getNodeCount();
+        int H = db.size();
+        if (N == matrixRows && log.size() == matrixRoadsSeen) return;
+
+        if (N > matrixRows) {
+            // New nodes start unreachable (rows are appended at the end)
+            distMatrix.resize((size_t)N * H, 1e9f);
+            for (int h = 0; h < H; h++) {
+                if (hospNodeIds[h] != -1) continue;
+                int id = graph.getNodeId(db[h].locationNode);
+                if (id != -1) {
+                    hospNodeIds[h] = id;
+                    distMatrix[(size_t)id * H + h] = 0.0f;
+                }
+            }
+            matrixRows = N;
+        }
+
+        for (size_t i = matrixRoadsSeen; i < log.size(); i++) {
+            relaxNewRoad(graph, log[i]);
+        }
+        matrixRoadsSeen = log.size();
+    }
+
+    bool matrixUpToDate(const AreaGraph& graph) const {
+        return useMatrix && &graph == matrixGraph
+            && graph.getNodeCount() == matrixRows
+            && graph.getRoadLog().size() == matrixRoadsSeen;
+    }
+
+    // Rank hospitals using one precomputed row: score the whole row, select
+    // the best k (k <= 0 means all), and only copy the data of those. Read-only.
+    vector<HospitalScoreWrapper> rankMatrixRow(int row, int k) const {
+        vector<HospitalScoreWrapper> results;
+        if (row < 0) return results;
+
+        int H = db.size();
+        const float* dists = distMatrix.data() + (size_t)row * H;
+        vector<double> scores;
+        scoreMatrixRow(row, scores);
+
+        vector<int> order;
+        order.reserve(H);
+        for (int h = 0; h < H; h++) {
+            if (dists[h] < 1e8f) order.push_back(h);
+        }
+        // Ties keep db order, same as a stable sort
+        auto better = [&](int a, int b) {
+            return scores[a] < scores[b] || (scores[a] == scores[b] && a < b);
+        };
+        int keep = (k <= 0 || k > (int)order.size()) ? order.size() : k;
+        partial_sort(order.begin(), order.begin() + keep, order.end(), better);
+
+        results.reserve(keep);
+        for (int i = 0; i < keep; i++) {
+            int h = order[i];
+            results.push_back({db[h], scores[h], dists[h], status.rating[h]});
+        }
+        return results;
+    }
+
+    // Score the whole row in one flat loop (policy is inlined here)
+    void scoreMatrixRow(int row, vector<double>& scores) const {
+        int H = db.size();
+        const float* dists = distMatrix.data() + (size_t)row * H;
+        scores.resize(H);
+        for (int h = 0; h < H; h++) {
+            scores[h] = ScoringPolicy::score(dists[h], status, h);
+        }
+    }
 
 public:
-    HospitalRecommender() {
+    BasicHospitalRecommender() {
         // Initialize with User Provided Data
-        // Format: {Name, NodeName, DisplayLocation, Rating}
-        db.push_back({"PIMS", "PIMS", "G-8/3 G 8/3 G-8, Islamabad", 3.8});
-        db.push_back({"Shifa International", "Shifa", "H 8/4 H-8, Islamabad", 4.2});
-        db.push_back({"Kulsum International", "Kulsum", "Block E G 6/2 Blue Area, Islamabad", 3.7});
-        db.push_back({"Maroof International", "Maroof", "F-10 Markaz F 10/3 F-10, Islamabad", 3.2}); // Connected to G-10
-        db.push_back({"MH Hospital", "MH", "Saddar, Rawalpindi", 4.1});
-        db.push_back({"Marya Memorial Hospital", "Marya Memorial Hospital ", "Peshawar Rd , Rawalpindi", 4.5}); // Note space
-        db.push_back({"Primax Medical Complex", "Primax Medical Complex", "Murree Rd , Rawalpindi", 4.8});
+        // Format: {Name, NodeName, DisplayLocation}, Rating
+        addHospital({"PIMS", "PIMS", "G-8/3 G 8/3 G-8, Islamabad"}, 3.8);
+        addHospital({"Shifa International", "Shifa", "H 8/4 H-8, Islamabad"}, 4.2);
+        addHospital({"Kulsum International", "Kulsum", "Block E G 6/2 Blue Area, Islamabad"}, 3.7);
+        addHospital({"Maroof International", "Maroof", "F-10 Markaz F 10/3 F-10, Islamabad"}, 3.2); // Connected to G-10
+        addHospital({"MH Hospital", "MH", "Saddar, Rawalpindi"}, 4.1);
+        addHospital({"Marya Memorial Hospital", "Marya Memorial Hospital ", "Peshawar Rd , Rawalpindi"}, 4.5); // Note space
+        addHospital({"Primax Medical Complex", "Primax Medical Complex", "Murree Rd , Rawalpindi"}, 4.8);
+    }
+
+    void addHospital(const HospitalData& hosp, double rating) {
+        int h = db.size();
+        nameIndex[hosp.name] = h;
+        db.push_back(hosp);
+        status.push(rating);
+        status.penalty[h] = ScoringPolicy::penalty(status, h);
+
+        // A new hospital is a new matrix column: simplest to rebuild
+        if (useMatrix) enableDistanceMatrix(*matrixGraph);
+    }
+
+    int getHospitalCount() const { return db.size(); }
+
+    // Apply one streamed status message. Only the status table changes,
+    // so no distances are recomputed. Returns false for unknown hospitals.
+    bool applyStatusUpdate(const HospitalStatusUpdate& update) {
+        auto it = nameIndex.find(update.hospitalName);
+        if (it == nameIndex.end()) return false;
+        int h = it->second;
+        status.availableBeds[h] = update.availableBeds;
+        status.waitMinutes[h] = update.waitMinutes;
+        status.flags[h] = update.flags;
+        status.penalty[h] = ScoringPolicy::penalty(status, h);
+        return true;
+    }
+
+    const HospitalStatusTable& getStatusTable() const { return status; }
+
+    // Hospital db, status table and (if enabled) the distance matrix
+    size_t memoryUsage() const {
+        size_t total = heapBytes(db) + heapBytes(nameIndex);
+        for (const auto& hosp : db) {
+            total += heapBytes(hosp.name) + heapBytes(hosp.locationNode) + heapBytes(hosp.fullLocation);
+        }
+        for (const auto& entry : nameIndex) total += heapBytes(entry.first);
+        total += heapBytes(status.rating) + heapBytes(status.availableBeds)
+               + heapBytes(status.waitMinutes) + heapBytes(status.flags) + heapBytes(status.penalty);
+        total += heapBytes(hospNodeIds) + heapBytes(distMatrix);
+        return total;
+    }
+
+    // Precompute distances from every area to every hospital so later
+    // getRecommendations calls on this graph skip Dijkstra entirely.
+    // Roads are two-way, so one Dijkstra per hospital (run in parallel on
+    // the shared worker pool) gives the distance from every area to it.
+    void enableDistanceMatrix(AreaGraph& graph, WorkStealingPool& pool = sharedWorkerPool()) {
+        int H = db.size();
+        int N = graph.getNodeCount();
+
+        hospNodeIds.assign(H, -1);
+        for (int h = 0; h < H; h++) {
+            hospNodeIds[h] = graph.getNodeId(db[h].locationNode);
+        }
+
+        // Each task fills one hospital's column of the per-area float rows
+        distMatrix.assign((size_t)N * H, 1e9f);
+        vector<SearchState> states(pool.getWorkerCount());
+        pool.run(H, [&](int worker, int h) {
+            SearchState& state = states[worker];
+            graph.shortestDistancesFrom(hospNodeIds[h], state);
+            for (int n = 0; n < N; n++) {
+                distMatrix[(size_t)n * H + h] = (float)state.dist[n];
+            }
+        });
+
+        matrixRows = N;
+        matrixRoadsSeen = graph.getRoadLog().size();
+        matrixGraph = &graph;
+        useMatrix = true;
+    }
+
+    // Change a hospital's rating. With the matrix enabled this only changes
+    // the score, the stored distances stay valid.
+    bool updateRating(const string& hospitalName, double rating) {
+        auto it = nameIndex.find(hospitalName);
+        if (it == nameIndex.end()) return false;
+        int h = it->second;
+        status.rating[h] = rating;
+        status.penalty[h] = ScoringPolicy::penalty(status, h);
+        return true;
     }
 
-    vector<HospitalScoreWrapper> getRecommendations(string userArea, AreaGraph& graph) {
+    // Best k hospitals for the area, best first (k <= 0 means all of them)
+    vector<HospitalScoreWrapper> getRecommendations(string userArea, AreaGraph& graph, int k = 0) {
+        if (useMatrix && &graph == matrixGraph) {
+            syncDistanceMatrix(graph);
+            return rankMatrixRow(graph.getNodeId(userArea), k);
+        }
+
         // 1. Get real distances from the graph
         unordered_map<string, double> distances = graph.getShortestPaths(userArea);
 
         // Min Heap to rank hospitals
         priority_queue<HospitalScoreWrapper, vector<HospitalScoreWrapper>, greater<HospitalScoreWrapper>> minHeap;
 
-        for (const auto& hosp : db) {
+        for (int h = 0; h < (int)db.size(); h++) {
+            const HospitalData& hosp = db[h];
             // Check if hospital is reachable
             if (distances.find(hosp.locationNode) != distances.end() && distances[hosp.locationNode] < 1e8) {
                 double dist = distances[hosp.locationNode];
-                double score = hosp.getScore(dist);
-                minHeap.push({hosp, score, dist});
+                double score = ScoringPolicy::score(dist, status, h);
+                minHeap.push({hosp, score, dist, status.rating[h]});
+            }
+        }
+
+        vector<HospitalScoreWrapper> results;
+        while (!minHeap.empty() && (k <= 0 || (int)results.size() < k)) {
+            results.push_back(minHeap.top());
+            minHeap.pop();
+        }
+        return results;
+    }
+
+    // Scores every hospital for one area without sorting (matrix mode only).
+    // Returns false if the matrix is not enabled/up to date or the area is unknown.
+    bool scoreArea(const string& userArea, const AreaGraph& graph, vector<double>& scores) const {
+        int row = graph.getNodeId(userArea);
+        if (!matrixUpToDate(graph) || row < 0) return false;
+        scoreMatrixRow(row, scores);
+        return true;
+    }
+
+    // Apply any roads/areas added since the matrix was built. Call this
+    // before handing the recommender to several threads at once.
+    void refreshDistanceMatrix(AreaGraph& graph) {
+        if (useMatrix && &graph == matrixGraph) syncDistanceMatrix(graph);
+    }
+
+    // Thread-safe variant for batch use: only reads the graph, the db and
+    // (if it is up to date) the distance matrix. 'state' is the caller's
+    // own scratch space for Dijkstra.
+    vector<HospitalScoreWrapper> getRecommendations(const string& userArea, const AreaGraph& graph, SearchState& state, int k = 0) const {
+        if (matrixUpToDate(graph)) {
+            return rankMatrixRow(graph.getNodeId(userArea), k);
+        }
+
+        int startId = graph.getNodeId(userArea);
+        if (startId == -1) return {};
+        graph.shortestDistancesFrom(startId, state);
+        return rankDistances(graph, state.dist, k);
+    }
+
+    // Rank hospitals from a finished search: distById[node id] is the
+    // distance from the user's area (1e9 = unreachable). Best k, as above.
+    vector<HospitalScoreWrapper> rankDistances(const AreaGraph& graph, const vector<double>& distById, int k = 0) const {
+        priority_queue<HospitalScoreWrapper, vector<HospitalScoreWrapper>, greater<HospitalScoreWrapper>> minHeap;
+        for (int h = 0; h < (int)db.size(); h++) {
+            int id = graph.getNodeId(db[h].locationNode);
+            if (id != -1 && id < (int)distById.size() && distById[id] < 1e8) {
+                double dist = distById[id];
+                minHeap.push({db[h], ScoringPolicy::score(dist, status, h), dist, status.rating[h]});
             }
         }
 
         vector<HospitalScoreWrapper> results;
-        while (!minHeap.empty()) {
+        while (!minHeap.empty() && (k <= 0 || (int)results.size() < k)) {
             results.push_back(minHeap.top());
             minHeap.pop();
         }
         return results;
     }
+
+    // True when getRecommendations can answer from the matrix without a search
+    bool canUseMatrix(const AreaGraph& graph) const { return matrixUpToDate(graph); }
 };
 
+// The app's default recommender uses the original distance + rating formula
+typedef BasicHospitalRecommender<DistanceRatingScore> HospitalRecommender;
+
 #endif
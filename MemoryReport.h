@@ -0,0 +1,67 @@
+#ifndef MEMORYREPORT_H
+#define MEMORYREPORT_H
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstddef>
+
+using namespace std;
+
+// ==========================================
+// Memory Footprint Accounting
+// ==========================================
+
+// Heap bytes per subsystem. These are estimates from container sizes and
+// capacities (the allocator's own bookkeeping is not included), good
+// enough to see which part grows with the catalog or the map.
+struct MemoryReport {
+    size_t catalogBytes = 0;       // DiseaseList nodes + string pool
+    size_t symptomIndexBytes = 0;  // SymptomChecker / SparseSymptomModel
+    size_t graphBytes = 0;         // AreaGraph (both adjacency lists, road log)
+    size_t recommenderBytes = 0;   // Hospital db, status table, distance matrix
+
+    size_t total() const {
+        return catalogBytes + symptomIndexBytes + graphBytes + recommenderBytes;
+    }
+};
+
+// ---- Helpers used by the memoryUsage() methods ----
+
+// Heap part of a string (0 when it fits in the small-string buffer)
+inline size_t heapBytes(const string& s) {
+    return s.capacity() > string().capacity() ? s.capacity() + 1 : 0;
+}
+
+template <typename T>
+inline size_t heapBytes(const vector<T>& v) {
+    return v.capacity() * sizeof(T);
+}
+
+inline size_t heapBytes(const vector<string>& v) {
+    size_t total = v.capacity() * sizeof(string);
+    for (const auto& s : v) total += heapBytes(s);
+    return total;
+}
+
+// Bucket array + one node per entry; keys/values' own heap data is added
+// by the caller if they have any.
+template <typename K, typename V>
+inline size_t heapBytes(const unordered_map<K, V>& m) {
+    return m.bucket_count() * sizeof(void*) + m.size() * (sizeof(pair<const K, V>) + 2 * sizeof(void*));
+}
+
+// Fills a report from the four subsystems (templated so it works with
+// any scoring policy of BasicHospitalRecommender)
+template <typename Catalog, typename Checker, typename Graph, typename Recommender>
+MemoryReport buildMemoryReport(const Catalog& catalog, const Checker& checker,
+                               const Graph& graph, const Recommender& recommender) {
+    MemoryReport report;
+    report.catalogBytes = catalog.memoryUsage();
+    report.symptomIndexBytes = checker.memoryUsage();
+    report.graphBytes = graph.memoryUsage();
+    report.recommenderBytes = recommender.memoryUsage();
+    return report;
+}
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <memory>
+#include <new>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include "MemoryReport.h"
+
+using namespace std;
+
+// ==========================================
+// Compact String Storage for the Catalog
+// ==========================================
+
+// A read-only list of strings stored inside a StringPool.
+// Works like a small vector<string_view>: size(), [i], range-for.
+struct StringList {
+    const string_view* first = nullptr;
+    uint32_t count = 0;
+
+    uint32_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const string_view& operator[](uint32_t i) const { return first[i]; }
+    const string_view* begin() const { return first; }
+    const string_view* end() const { return first + count; }
+};
+
+// Append-only memory in blocks (4 KB, doubling up to 64 KB), so thousands
+// of strings cost a handful of allocations, and nothing ever moves.
+class BlockArena {
+private:
+    static constexpr size_t FIRST_BLOCK = 4 * 1024;
+    static constexpr size_t MAX_BLOCK = 64 * 1024;
+
+    vector<unique_ptr<char[]>> blocks;
+    vector<size_t> blockSizes;
+    size_t blockUsed = 0;
+    size_t bytesRequested = 0;
+
+public:
+    char* allocate(size_t bytes, size_t align) {
+        size_t start = (blockUsed + align - 1) & ~(align - 1);
+        if (blocks.empty() || start + bytes > blockSizes.back()) {
+            size_t size = blocks.empty() ? FIRST_BLOCK : min(blockSizes.back() * 2, MAX_BLOCK);
+            if (size < bytes) size = bytes;
+            blocks.emplace_back(new char[size]);
+            blockSizes.push_back(size);
+            start = 0;
+        }
+        blockUsed = start + bytes;
+        bytesRequested += bytes;
+        return blocks.back().get() + start;
+    }
+
+    string_view copy(string_view text) {
+        if (text.empty()) return string_view();
+        char* dest = allocate(text.size(), 1);
+        memcpy(dest, text.data(), text.size());
+        return string_view(dest, text.size());
+    }
+
+    size_t memoryUsage() const {
+        size_t total = 0;
+        for (size_t s : blockSizes) total += s;
+        return total + heapBytes(blocks) + heapBytes(blockSizes);
+    }
+
+    size_t payloadBytes() const { return bytesRequested; }
+};
+
+// Owns all catalog text. The string_views handed out stay valid as long
+// as the pool lives.
+//
+// - intern(): short repeated strings (names, symptoms, preventions) are
+//   stored once; "Nausea" in five diseases is one copy. They share an
+//   arena with the string_view lists that point at them.
+// - pack():   long one-off text (descriptions) goes to a separate
+//   append-only buffer, so it never splits up the short strings.
+class StringPool {
+private:
+    BlockArena shortText;   // interned strings + StringList arrays
+    BlockArena longText;    // pack()ed descriptions
+
+    unordered_map<string_view, uint32_t> lookup; // text -> id
+    vector<string_view> interned;                // id -> text
+
+public:
+    StringPool() = default;
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    // Copy text into the pool without deduplication
+    string_view pack(string_view text) { return longText.copy(text); }
+
+    // Returns the compact id of 'text', storing it the first time it is seen
+    uint32_t intern(string_view text) {
+        auto it = lookup.find(text);
+        if (it != lookup.end()) return it->second;
+        uint32_t id = interned.size();
+        string_view stored = shortText.copy(text);
+        interned.push_back(stored);
+        lookup[stored] = id;
+        return id;
+    }
+
+    string_view get(uint32_t id) const { return interned[id]; }
+
+    uint32_t getInternedCount() const { return interned.size(); }
+
+    // Interns every string and stores the resulting views as one list
+    StringList internList(const vector<string>& items) {
+        StringList list;
+        if (items.empty()) return list;
+        string_view* views = reinterpret_cast<string_view*>(
+            shortText.allocate(items.size() * sizeof(string_view), alignof(string_view)));
+        for (size_t i = 0; i < items.size(); i++) {
+            new (&views[i]) string_view(get(intern(items[i])));
+        }
+        list.first = views;
+        list.count = items.size();
+        return list;
+    }
+
+    // Bytes actually reserved by the pool (blocks + lookup tables)
+    size_t memoryUsage() const {
+        size_t total = shortText.memoryUsage() + longText.memoryUsage();
+        total += heapBytes(interned) + heapBytes(lookup); // lookup keys point into the blocks
+        return total;
+    }
+
+    // Bytes of text/lists stored (without block slack)
+    size_t payloadBytes() const { return shortText.payloadBytes() + longText.payloadBytes(); }
+};
+
+#endif
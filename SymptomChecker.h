@@ -4,7 +4,7 @@
 #include <vector>
 #include <string>
 #include <unordered_map>
-#include <set>
+#include <algorithm>
 #include <queue>
 #include <iostream>
 #include "Disease.h"
@@ -26,18 +26,43 @@ struct MatchResult {
     }
 };
 
+#include "SymptomModel.h" // Weighted scoring mode (uses MatchResult)
+
+enum ScoringMode {
+    MATCH_FRACTION,    // % of the disease's symptoms that were mentioned
+    SEVERITY_WEIGHTED  // Rare symptoms and severe diseases count more (SparseSymptomModel)
+};
+
 class SymptomChecker {
 private:
     // We need access to the Disease List to know what symptoms define a disease
     DiseaseList* diseaseListRef;
 
+    ScoringMode mode;
+    SparseSymptomModel weightedModel;
+
 public:
     SymptomChecker(DiseaseList* list) {
         diseaseListRef = list;
+        mode = MATCH_FRACTION;
+    }
+
+    void setScoringMode(ScoringMode newMode) { mode = newMode; }
+    ScoringMode getScoringMode() const { return mode; }
+
+    // Weighted mode, best k results only (k <= 0 means all).
+    // New diseases in the list are added to the model on the fly.
+    vector<MatchResult> predictDiseaseTopK(const vector<string>& userSymptoms, int k) {
+        weightedModel.sync(diseaseListRef);
+        return weightedModel.predict(userSymptoms, k);
     }
 
     // Main Logic: Calculate match % and return top results
     vector<MatchResult> predictDisease(const vector<string>& userSymptoms) {
+        if (mode == SEVERITY_WEIGHTED) {
+            return predictDiseaseTopK(userSymptoms, 0);
+        }
+
         priority_queue<MatchResult> maxHeap;
         
         // Traverse the Linked List of all diseases
@@ -51,7 +76,7 @@ public:
                 // Check matches
                 // Optimization: In a larger app, we might use a Hash Set for symptoms
                 // but for ~5 symptoms per disease, nested loop is perfectly fine and simple.
-                for (const string& dSym : current->symptoms) {
+                for (string_view dSym : current->symptoms) {
                     for (const string& uSym : userSymptoms) {
                         // Simple substring find to be more user friendly (e.g. "pain" matches "chest pain")
                         // Or exact match. Let's do simple cleaning logic if needed, but here simple find:
@@ -64,7 +89,7 @@ public:
 
                 if (matches > 0) {
                     double percent = ((double)matches / totalDiseaseSymptoms) * 100.0;
-                    maxHeap.push({current->name, percent});
+                    maxHeap.push({string(current->name), percent});
                 }
             }
             current = current->next;
@@ -80,17 +105,25 @@ public:
     }
 
     // Helper: Get all unique symptoms for the frontend dropdown/checkboxes
-    set<string> getUniqueSymptoms() {
-        set<string> distinctSymptoms;
+    // (sorted; views point into the catalog's string pool, nothing is copied)
+    vector<string_view> getUniqueSymptoms() {
+        vector<string_view> distinctSymptoms;
         Disease* current = diseaseListRef->getHead();
         while (current != nullptr) {
-            for (const string& s : current->symptoms) {
-                distinctSymptoms.insert(s);
+            for (string_view s : current->symptoms) {
+                distinctSymptoms.push_back(s);
             }
             current = current->next;
         }
+        sort(distinctSymptoms.begin(), distinctSymptoms.end());
+        distinctSymptoms.erase(unique(distinctSymptoms.begin(), distinctSymptoms.end()), distinctSymptoms.end());
         return distinctSymptoms;
     }
+
+    // Only the weighted model owns memory here (the catalog is counted separately)
+    size_t memoryUsage() const {
+        return weightedModel.memoryUsage();
+    }
 };
 
 #endif
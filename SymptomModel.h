@@ -0,0 +1,243 @@
+#ifndef SYMPTOMMODEL_H
+#define SYMPTOMMODEL_H
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
+#include <cctype>
+#include "Disease.h"
+#include "MemoryReport.h"
+
+using namespace std;
+
+// Included from SymptomChecker.h, after MatchResult is declared.
+
+// ==============================================================
+// FEATURE 2b: Weighted Symptom Scoring (Sparse Matrix + Top-K)
+// ==============================================================
+
+// Weighted version of the symptom checker. Each (disease, symptom) pair
+// gets a weight:
+//
+//     weight = idf(symptom) / sum of idf over the disease's symptoms
+//
+// idf = log((1 + D) / (1 + diseases with this symptom)) + 1, so a rare
+// symptom like "Blue skin tint" counts for more than a common one like
+// "Nausea". A disease's summed weights are the share of its evidence
+// the query covers (0..1). The disease's score is that share times
+// severityWeight = 0.5 + 0.05 * severity, so severe diseases rank a
+// little higher on the same evidence. Results are sorted by this score
+// and the reported percentage is a fixed curve over it, so the order and
+// the numbers always agree.
+//
+// The weights are stored transposed, one CSR row per symptom listing the
+// diseases that have it. A query only walks the rows of the symptoms it
+// mentions, so its cost grows with the number of matching entries, not
+// with the size of the catalog.
+class SparseSymptomModel {
+private:
+    // ---- Vocabulary ----
+    unordered_map<string, int> phraseIndex;        // normalized symptom -> symptom id
+    unordered_map<string, vector<int>> wordIndex;  // normalized word -> symptom ids
+    vector<int> docFreq;                           // diseases per symptom id
+
+    // ---- Diseases (in DiseaseList order) ----
+    vector<Disease*> diseases;
+    vector<float> severityWeight;
+    Disease* lastIndexed = nullptr; // last linked-list node already in the model
+
+    // ---- CSR: row = symptom id, columns = disease ids ----
+    vector<int> rowStart;      // size = symptoms + 1
+    vector<int> colDisease;
+    vector<float> value;
+    vector<pair<int, int>> pendingEntries; // (symptom, disease) not merged into the CSR yet
+    bool dirty = false;
+
+    // ---- Scratch space reused across queries ----
+    vector<float> accum;       // per disease, always back to 0 after a query
+    vector<int> touched;       // diseases with a non-zero accum
+    vector<char> querySeen;    // per symptom, avoids counting a symptom twice
+
+    static string normalize(string_view text) {
+        string out;
+        for (char c : text) {
+            if (isalnum((unsigned char)c)) out += tolower((unsigned char)c);
+        }
+        return out;
+    }
+
+    int getOrCreateSymptom(string_view symptom) {
+        string key = normalize(symptom);
+        auto it = phraseIndex.find(key);
+        if (it != phraseIndex.end()) return it->second;
+
+        int id = docFreq.size();
+        phraseIndex[key] = id;
+        docFreq.push_back(0);
+        querySeen.push_back(0);
+
+        // Index each word too, so "pain" finds "Chest pain" and "Pain in arm"
+        string word;
+        for (size_t i = 0; i <= symptom.size(); i++) {
+            if (i < symptom.size() && !isspace((unsigned char)symptom[i])) {
+                word += symptom[i];
+            } else if (!word.empty()) {
+                vector<int>& ids = wordIndex[normalize(word)];
+                if (ids.empty() || ids.back() != id) ids.push_back(id);
+                word = "";
+            }
+        }
+        return id;
+    }
+
+    void addToModel(Disease* d) {
+        int diseaseId = diseases.size();
+        diseases.push_back(d);
+        severityWeight.push_back(0.5f + 0.05f * d->severity);
+        accum.push_back(0.0f);
+
+        vector<int> seen;
+        for (string_view s : d->symptoms) {
+            int id = getOrCreateSymptom(s);
+            if (find(seen.begin(), seen.end(), id) != seen.end()) continue;
+            seen.push_back(id);
+            docFreq[id]++;
+            pendingEntries.push_back({id, diseaseId});
+        }
+        dirty = true;
+    }
+
+    // Merge pending entries into the CSR and recompute the weights.
+    // Only runs after diseases were added; a plain query skips it.
+    void refresh() {
+        if (!dirty) return;
+        int symptomCount = docFreq.size();
+        int diseaseCount = diseases.size();
+
+        // 1. Merge structure (counting sort by symptom id)
+        vector<int> newStart(symptomCount + 1, 0);
+        for (int s = 0; s + 1 < (int)rowStart.size(); s++) newStart[s + 1] += rowStart[s + 1] - rowStart[s];
+        for (const auto& e : pendingEntries) newStart[e.first + 1]++;
+        for (int s = 0; s < symptomCount; s++) newStart[s + 1] += newStart[s];
+
+        vector<int> newCols(newStart[symptomCount]);
+        vector<int> fill(newStart.begin(), newStart.end() - 1);
+        for (int s = 0; s + 1 < (int)rowStart.size(); s++) {
+            for (int k = rowStart[s]; k < rowStart[s + 1]; k++) newCols[fill[s]++] = colDisease[k];
+        }
+        for (const auto& e : pendingEntries) newCols[fill[e.first]++] = e.second;
+
+        rowStart.swap(newStart);
+        colDisease.swap(newCols);
+        pendingEntries.clear();
+
+        // 2. Weights (idf depends on the catalog size, so all of them change)
+        vector<float> idf(symptomCount);
+        for (int s = 0; s < symptomCount; s++) {
+            idf[s] = log((1.0f + diseaseCount) / (1.0f + docFreq[s])) + 1.0f;
+        }
+
+        vector<float> norm(diseaseCount, 0.0f);
+        for (int s = 0; s < symptomCount; s++) {
+            for (int k = rowStart[s]; k < rowStart[s + 1]; k++) norm[colDisease[k]] += idf[s];
+        }
+
+        value.resize(colDisease.size());
+        for (int s = 0; s < symptomCount; s++) {
+            for (int k = rowStart[s]; k < rowStart[s + 1]; k++) {
+                int d = colDisease[k];
+                value[k] = idf[s] / norm[d];
+            }
+        }
+        dirty = false;
+    }
+
+public:
+    // Picks up diseases appended to the list since the last call
+    void sync(DiseaseList* list) {
+        Disease* node = lastIndexed ? lastIndexed->next : list->getHead();
+        while (node != nullptr) {
+            addToModel(node);
+            lastIndexed = node;
+            node = node->next;
+        }
+    }
+
+    // Top-k diseases for the given symptoms (k <= 0 means all matches).
+    // percentage squashes the score into 0-100 with a fixed logistic curve,
+    // 1 / (1 + e^(-6 * (score - 0.5))). The curve is not fitted to outcome
+    // data: it is not a probability, it only keeps the order of the scores.
+    vector<MatchResult> predict(const vector<string>& userSymptoms, int k) {
+        refresh();
+
+        // Look up the query terms: whole symptom first, then single word
+        vector<int> symptomIds;
+        for (const string& term : userSymptoms) {
+            string key = normalize(term);
+            auto phrase = phraseIndex.find(key);
+            if (phrase != phraseIndex.end()) {
+                if (!querySeen[phrase->second]) {
+                    querySeen[phrase->second] = 1;
+                    symptomIds.push_back(phrase->second);
+                }
+                continue;
+            }
+            auto word = wordIndex.find(key);
+            if (word == wordIndex.end()) continue;
+            for (int id : word->second) {
+                if (!querySeen[id]) {
+                    querySeen[id] = 1;
+                    symptomIds.push_back(id);
+                }
+            }
+        }
+
+        // Sparse dot product: walk only the matching rows
+        for (int s : symptomIds) {
+            querySeen[s] = 0;
+            for (int j = rowStart[s]; j < rowStart[s + 1]; j++) {
+                int d = colDisease[j];
+                if (accum[d] == 0.0f) touched.push_back(d);
+                accum[d] += value[j];
+            }
+        }
+
+        // score = evidence share * severity weight (stored back into accum)
+        for (int d : touched) accum[d] *= severityWeight[d];
+
+        // Top-k selection over the touched diseases only
+        auto better = [&](int a, int b) {
+            return accum[a] > accum[b] || (accum[a] == accum[b] && a < b);
+        };
+        int keep = (k <= 0 || k > (int)touched.size()) ? touched.size() : k;
+        partial_sort(touched.begin(), touched.begin() + keep, touched.end(), better);
+
+        vector<MatchResult> results;
+        for (int i = 0; i < keep; i++) {
+            int d = touched[i];
+            double squashed = 1.0 / (1.0 + exp(-6.0 * (accum[d] - 0.5)));
+            results.push_back({string(diseases[d]->name), squashed * 100.0});
+        }
+
+        for (int d : touched) accum[d] = 0.0f;
+        touched.clear();
+        return results;
+    }
+
+    int getSymptomCount() const { return docFreq.size(); }
+    int getEntryCount() const { return colDisease.size() + pendingEntries.size(); }
+
+    size_t memoryUsage() const {
+        size_t total = heapBytes(phraseIndex) + heapBytes(wordIndex);
+        for (const auto& entry : phraseIndex) total += heapBytes(entry.first);
+        for (const auto& entry : wordIndex) total += heapBytes(entry.first) + heapBytes(entry.second);
+        total += heapBytes(docFreq) + heapBytes(diseases) + heapBytes(severityWeight);
+        total += heapBytes(rowStart) + heapBytes(colDisease) + heapBytes(value) + heapBytes(pendingEntries);
+        total += heapBytes(accum) + heapBytes(touched) + heapBytes(querySeen);
+        return total;
+    }
+};
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <algorithm>
+
+using namespace std;
+
+// Native builds and pthread-enabled wasm builds can spawn worker threads.
+// A plain wasm build has no threads, so the pool runs everything on the
+// calling thread.
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#define HEARTGUARD_THREADS 1
+#else
+#define HEARTGUARD_THREADS 0
+#endif
+
+// ==========================================
+// Work-Stealing Thread Pool (used by batch queries)
+// ==========================================
+
+// Every worker has its own deque of task indices. A worker takes tasks
+// from the back of its own deque; when it runs dry it steals from the
+// front of another worker's deque, so slow areas don't leave threads idle.
+// Worker 0 is always the thread that calls run().
+class WorkStealingPool {
+private:
+    struct WorkerQueue {
+        mutex lock;
+        deque<int> tasks;
+    };
+
+    vector<unique_ptr<WorkerQueue>> queues;
+    vector<thread> threads;
+
+    mutex jobMutex;
+    condition_variable jobReady;
+    condition_variable jobDone;
+    const function<void(int, int)>* job = nullptr;
+    int generation = 0;
+    int busyWorkers = 0;
+    bool stopping = false;
+
+    bool popLocal(int w, int& task) {
+        lock_guard<mutex> lk(queues[w]->lock);
+        if (queues[w]->tasks.empty()) return false;
+        task = queues[w]->tasks.back();
+        queues[w]->tasks.pop_back();
+        return true;
+    }
+
+    bool steal(int w, int& task) {
+        int n = queues.size();
+        for (int k = 1; k < n; k++) {
+            WorkerQueue& victim = *queues[(w + k) % n];
+            lock_guard<mutex> lk(victim.lock);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.front();
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void drain(int w) {
+        int task;
+        while (popLocal(w, task) || steal(w, task)) {
+            (*job)(w, task);
+        }
+    }
+
+    void workerLoop(int w) {
+        int seen = 0;
+        while (true) {
+            {
+                unique_lock<mutex> lk(jobMutex);
+                jobReady.wait(lk, [&]() { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            drain(w);
+            {
+                lock_guard<mutex> lk(jobMutex);
+                if (--busyWorkers == 0) jobDone.notify_all();
+            }
+        }
+    }
+
+public:
+    // workerCount = 0 means "one per hardware thread"
+    explicit WorkStealingPool(int workerCount = 0) {
+#if HEARTGUARD_THREADS
+        if (workerCount <= 0) workerCount = max(1u, thread::hardware_concurrency());
+#else
+        workerCount = 1;
+#endif
+        for (int w = 0; w < workerCount; w++) {
+            queues.push_back(make_unique<WorkerQueue>());
+        }
+#if HEARTGUARD_THREADS
+        for (int w = 1; w < workerCount; w++) {
+            threads.emplace_back(&WorkStealingPool::workerLoop, this, w);
+        }
+#endif
+    }
+
+    ~WorkStealingPool() {
+        {
+            lock_guard<mutex> lk(jobMutex);
+            stopping = true;
+        }
+        jobReady.notify_all();
+        for (auto& t : threads) t.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int getWorkerCount() const { return queues.size(); }
+
+    // Calls fn(workerIndex, taskIndex) once for every task in [0, taskCount)
+    // and returns when all of them are done. workerIndex lets the caller keep
+    // per-worker scratch data (e.g. one SearchState per worker).
+    void run(int taskCount, const function<void(int, int)>& fn) {
+        int n = queues.size();
+
+        // Hand out contiguous blocks; stealing evens out the rest
+        for (int w = 0; w < n; w++) {
+            int begin = (long long)taskCount * w / n;
+            int end = (long long)taskCount * (w + 1) / n;
+            lock_guard<mutex> lk(queues[w]->lock);
+            for (int t = begin; t < end; t++) queues[w]->tasks.push_back(t);
+        }
+
+        {
+            lock_guard<mutex> lk(jobMutex);
+            job = &fn;
+            busyWorkers = threads.size();
+            generation++;
+        }
+        jobReady.notify_all();
+
+        drain(0);
+
+        unique_lock<mutex> lk(jobMutex);
+        jobDone.wait(lk, [&]() { return busyWorkers == 0; });
+        job = nullptr;
+    }
+};
+
+// The app's one worker pool. Everything that wants threads (coverage
+// batches, distance matrix builds) runs on it, so a pthreads wasm build
+// never needs more workers than PTHREAD_POOL_SIZE provides.
+// run() must not be called from two threads at the same time.
+inline WorkStealingPool& sharedWorkerPool() {
+    static WorkStealingPool pool;
+    return pool;
+}
+
+#endif
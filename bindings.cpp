@@ -5,6 +5,8 @@
 #include "SymptomChecker.h"
 #include "HospitalGraph.h"
 #include "HospitalRecommender.h"
+#include "CoveragePlanner.h"
+#include "AsyncQuery.h"
 
 using namespace emscripten;
 using namespace emscripten;
@@ -18,7 +20,13 @@ using namespace emscripten;
 DiseaseList globalDiseaseList;
 SymptomChecker* globalSymptomChecker;
 AreaGraph globalAreaGraph;
-HospitalRecommender globalRecommender;
+// Capacity-aware scoring: with no status updates it ranks exactly like
+// the plain distance + rating formula.
+BasicHospitalRecommender<CapacityAwareScore> globalRecommender;
+CoveragePlanner* globalCoveragePlanner = nullptr;
+AsyncQueryEngine globalQueryEngine;
+std::unordered_map<int, CancellationToken> globalQueryTokens; // Pending query id -> token
+int nextQueryId = 1;
 
 // Initialization Function (Called when page loads)
 void initSystem() {
@@ -41,7 +49,7 @@ val getAllDiseaseNames() {
     val names = val::array();
     Disease* head = globalDiseaseList.getHead();
     while(head != nullptr) {
-        names.call<void>("push", head->name);
+        names.call<void>("push", std::string(head->name));
         head = head->next;
     }
     return names;
@@ -53,17 +61,17 @@ val getDiseaseByName(std::string name) {
     val result = val::object();
     
     if (d != nullptr) {
-        result.set("name", d->name);
-        result.set("description", d->description);
+        result.set("name", std::string(d->name));
+        result.set("description", std::string(d->description));
         result.set("severity", d->severity);
         
         // Convert vectors to JS Arrays
         val syms = val::array();
-        for(const auto& s : d->symptoms) syms.call<void>("push", s);
+        for(const auto& s : d->symptoms) syms.call<void>("push", std::string(s));
         result.set("symptoms", syms);
         
         val prevs = val::array();
-        for(const auto& p : d->preventions) prevs.call<void>("push", p);
+        for(const auto& p : d->preventions) prevs.call<void>("push", std::string(p));
         result.set("preventions", prevs);
     } else {
         result.set("error", std::string("Not Found"));
@@ -98,6 +106,11 @@ val checkSymptoms(std::string commaSeparatedSymptoms) {
     return jsResults;
 }
 
+// Feature 2: Switch between plain match % and severity-weighted scoring
+void setWeightedSymptomScoring(bool enabled) {
+    globalSymptomChecker->setScoringMode(enabled ? SEVERITY_WEIGHTED : MATCH_FRACTION);
+}
+
 // Feature 3: Nearest Hospital
 val findNearest(std::string areaName) {
     PathResult res = globalAreaGraph.findNearestHospital(areaName);
@@ -120,18 +133,16 @@ val getAreaList() {
 }
 
 val getAllSymptoms() {
-    std::set<std::string> symptoms = globalSymptomChecker->getUniqueSymptoms();
+    std::vector<std::string_view> symptoms = globalSymptomChecker->getUniqueSymptoms();
     val jsArr = val::array();
     for(const auto& s : symptoms) {
-        jsArr.call<void>("push", s);
+        jsArr.call<void>("push", std::string(s));
     }
     return jsArr;
 }
 
 // Feature 4: Full Recommendations
-// Feature 4: Full Recommendations
-val getRecommendations(std::string areaName) {
-    std::vector<HospitalScoreWrapper> recs = globalRecommender.getRecommendations(areaName, globalAreaGraph);
+val recommendationsToJs(const std::vector<HospitalScoreWrapper>& recs) {
     val jsArr = val::array();
     
     for(const auto& r : recs) {
@@ -139,21 +150,155 @@ val getRecommendations(std::string areaName) {
         obj.set("name", r.data.name);
         obj.set("location", r.data.fullLocation); // Add location
         obj.set("distance", r.realDistance); // Use real calculated distance
-        obj.set("rating", r.data.rating);
+        obj.set("rating", r.rating);
         obj.set("score", r.score);
         jsArr.call<void>("push", obj);
     }
     return jsArr;
 }
 
+val getRecommendations(std::string areaName) {
+    return recommendationsToJs(globalRecommender.getRecommendations(areaName, globalAreaGraph));
+}
+
+// Feature 4: Precompute the area x hospital distance matrix (optional speed-up)
+void enableDistanceMatrix() {
+    globalRecommender.enableDistanceMatrix(globalAreaGraph);
+}
+
+// Feature 4: Live rating change (re-scores only, no re-routing)
+bool updateHospitalRating(std::string hospitalName, double rating) {
+    return globalRecommender.updateRating(hospitalName, rating);
+}
+
+// Feature 4: Live status feed (beds, ER wait, cardiac unit, ER open)
+bool updateHospitalStatus(std::string hospitalName, int availableBeds, float waitMinutes, bool cardiacUnit, bool erOpen) {
+    uint8_t flags = 0;
+    if (cardiacUnit) flags |= HOSP_CARDIAC_UNIT;
+    if (erOpen) flags |= HOSP_ER_OPEN;
+    return globalRecommender.applyStatusUpdate({hospitalName, availableBeds, waitMinutes, flags});
+}
+
+// Feature 5: Coverage map - nearest hospital + ranking for many areas at once
+// areaArray: JS array of area names (e.g. the result of getAreaList())
+val getCoverageMap(val areaArray, bool measureSpeedup) {
+    if (globalCoveragePlanner == nullptr) globalCoveragePlanner = new CoveragePlanner();
+
+    std::vector<std::string> areas = vecFromJSArray<std::string>(areaArray);
+    CoverageReport report = globalCoveragePlanner->buildCoverage(areas, globalAreaGraph, globalRecommender, measureSpeedup);
+
+    val entries = val::array();
+    for(const auto& e : report.entries) {
+        val obj = val::object();
+        obj.set("area", e.area);
+        obj.set("hospital", e.nearest.hospitalName);
+        obj.set("distance", e.nearest.totalDistance);
+
+        val pathArr = val::array();
+        for(const auto& p : e.nearest.path) pathArr.call<void>("push", p);
+        obj.set("path", pathArr);
+
+        obj.set("recommendations", recommendationsToJs(e.recommendations));
+        entries.call<void>("push", obj);
+    }
+
+    val result = val::object();
+    result.set("entries", entries);
+    result.set("workers", report.workers);
+    result.set("parallelMs", report.parallelMs);
+    result.set("sequentialMs", report.sequentialMs);
+    result.set("speedup", report.speedup);
+    return result;
+}
+
+// Memory footprint per subsystem (bytes), to check against the wasm heap
+val getMemoryReport() {
+    MemoryReport report = buildMemoryReport(globalDiseaseList, *globalSymptomChecker, globalAreaGraph, globalRecommender);
+    val result = val::object();
+    result.set("catalog", (double)report.catalogBytes);
+    result.set("symptomIndex", (double)report.symptomIndexBytes);
+    result.set("graph", (double)report.graphBytes);
+    result.set("recommender", (double)report.recommenderBytes);
+    result.set("total", (double)report.total());
+    return result;
+}
+
+// Feature 6: Async queries. JS wraps these in a Promise (see script.js):
+// start* returns a query id, 'resolve' is called with {status, ...} when
+// the query finishes or is cancelled, and runQuerySlice() is pumped from
+// setTimeout so the page stays responsive between slices.
+ProgressCallback toProgressCallback(val onProgress) {
+    if (onProgress.isNull() || onProgress.isUndefined()) return nullptr;
+    return [onProgress](double p) { onProgress(p); };
+}
+
+std::string statusToJs(QueryStatus status) {
+    return status == QUERY_DONE ? "done" : "cancelled";
+}
+
+int startRecommendationsAsync(std::string areaName, val resolve, val onProgress) {
+    int id = nextQueryId++;
+    auto handle = globalQueryEngine.getRecommendationsAsync(areaName, globalAreaGraph, globalRecommender,
+                                                            toProgressCallback(onProgress));
+    globalQueryTokens[id] = handle.getToken();
+    handle.onComplete([id, resolve](const QueryOutcome<std::vector<HospitalScoreWrapper>>& outcome) {
+        globalQueryTokens.erase(id);
+        val result = val::object();
+        result.set("status", statusToJs(outcome.status));
+        result.set("results", recommendationsToJs(outcome.value));
+        resolve(result);
+    });
+    return id;
+}
+
+int startNearestAsync(std::string areaName, val resolve, val onProgress) {
+    int id = nextQueryId++;
+    auto handle = globalQueryEngine.findNearestHospitalAsync(areaName, globalAreaGraph, toProgressCallback(onProgress));
+    globalQueryTokens[id] = handle.getToken();
+    handle.onComplete([id, resolve](const QueryOutcome<PathResult>& outcome) {
+        globalQueryTokens.erase(id);
+        val result = val::object();
+        result.set("status", statusToJs(outcome.status));
+        result.set("hospital", outcome.value.hospitalName);
+        result.set("distance", outcome.value.totalDistance);
+
+        val pathArr = val::array();
+        for(const auto& p : outcome.value.path) pathArr.call<void>("push", p);
+        result.set("path", pathArr);
+        resolve(result);
+    });
+    return id;
+}
+
+void cancelQuery(int queryId) {
+    auto it = globalQueryTokens.find(queryId);
+    if (it != globalQueryTokens.end()) it->second.cancel();
+}
+
+// Runs one slice; returns true while queries are still pending
+bool runQuerySlice() {
+    globalQueryEngine.runSlice();
+    return globalQueryEngine.getPendingCount() > 0;
+}
+
 // BINDING DEFINITIONS
 EMSCRIPTEN_BINDINGS(my_module) {
     emscripten::function("initSystem", &initSystem);
     emscripten::function("getAllDiseaseNames", &getAllDiseaseNames);
     emscripten::function("getDiseaseByName", &getDiseaseByName);
     emscripten::function("checkSymptoms", &checkSymptoms);
+    emscripten::function("setWeightedSymptomScoring", &setWeightedSymptomScoring);
     emscripten::function("findNearest", &findNearest);
     emscripten::function("getAreaList", &getAreaList);
     emscripten::function("getAllSymptoms", &getAllSymptoms);
     emscripten::function("getRecommendations", &getRecommendations);
+    emscripten::function("enableDistanceMatrix", &enableDistanceMatrix);
+    emscripten::function("updateHospitalRating", &updateHospitalRating);
+    emscripten::function("updateHospitalStatus", &updateHospitalStatus);
+    emscripten::function("getCoverageMap", &getCoverageMap);
+    emscripten::function("getMemoryReport", &getMemoryReport);
+    emscripten::function("startRecommendationsAsync", &startRecommendationsAsync);
+    emscripten::function("startNearestAsync", &startNearestAsync);
+    emscripten::function("cancelQuery", &cancelQuery);
+    emscripten::function("runQuerySlice", &runQuerySlice);
 }
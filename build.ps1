@@ -1,3 +1,8 @@
+# Usage: .\build.ps1            (single-threaded wasm)
+#        .\build.ps1 -Threads   (pthreads wasm, batch queries run in parallel;
+#                                the page must be served with COOP/COEP headers)
+param([switch]$Threads)
+
 $ScriptDir = Split-Path -Parent $MyInvocation.MyCommand.Definition
 $EmsdkPath = Join-Path $ScriptDir "emsdk"
 
@@ -27,7 +32,17 @@ Write-Host ">>> Compiling C++ to WebAssembly..." -ForegroundColor Green
 # --bind: Enable Embind
 # -s WASM=1: Output WebAssembly
 # -o frontend/project.js: Output target
-$BuildCmd = "emcc.bat -I cpp cpp/bindings.cpp -o frontend/project.js --bind -s WASM=1 -s ALLOW_MEMORY_GROWTH=1 -s ""EXPORTED_RUNTIME_METHODS=['ccall','cwrap']"" -O3"
+# -std=c++20: async queries use coroutines
+# -pthread (optional): enables the shared worker pool (getCoverageMap and
+#   distance matrix builds); it uses hardwareConcurrency - 1 pthreads.
+#   emcc warns that pthreads + ALLOW_MEMORY_GROWTH can slow down JS access
+#   to the wasm heap (wasm code itself is unaffected). We keep growth on,
+#   since the distance matrix size depends on the map, and only cross the
+#   heap from JS once per query result, so that warning is silenced.
+$BuildCmd = "emcc.bat -std=c++20 -I cpp cpp/bindings.cpp -o frontend/project.js --bind -s WASM=1 -s ALLOW_MEMORY_GROWTH=1 -s ""EXPORTED_RUNTIME_METHODS=['ccall','cwrap']"" -O3"
+if ($Threads) {
+    $BuildCmd += " -pthread -s PTHREAD_POOL_SIZE=navigator.hardwareConcurrency -Wno-pthreads-mem-growth"
+}
 
 Write-Host "Running: $BuildCmd"
 Invoke-Expression $BuildCmd
@@ -219,6 +219,11 @@ function populateAreaDropdown() {
         opt.innerText = areas[i];
         select.appendChild(opt);
     }
+
+    // A recommendation request for the old area is no longer needed
+    select.addEventListener('change', () => {
+        if (currentRecQuery) currentRecQuery.cancel();
+    });
 }
 
 function findNearestHospital() {
@@ -252,7 +257,9 @@ function findNearestHospital() {
 // =======================
 // FEATURE 4: RECOMMENDATIONS
 // =======================
-function getTopHospitals() {
+let currentRecQuery = null;
+
+async function getTopHospitals() {
     // 1. Get the area selected in the previous section (Feature 3)
     const area = document.getElementById('area-dropdown').value;
 
@@ -263,8 +270,15 @@ function getTopHospitals() {
         return;
     }
 
-    // 2. Call C++ with the real area
-    const recs = Module.getRecommendations(area);
+    // 2. Call C++ with the real area (async: a newer request cancels this one)
+    if (currentRecQuery) currentRecQuery.cancel();
+    const query = getRecommendationsAsync(area);
+    currentRecQuery = query;
+
+    const outcome = await query;
+    if (currentRecQuery === query) currentRecQuery = null;
+    if (outcome.status !== 'done') return; // superseded by a newer request
+    const recs = outcome.results;
 
     const tbody = document.getElementById('rec-table-body');
     tbody.innerHTML = '';
@@ -285,3 +299,58 @@ function getTopHospitals() {
         tbody.innerHTML += row;
     }
 }
+
+// =======================
+// FEATURE 6: ASYNC QUERIES
+// =======================
+// C++ runs long searches in small slices; we run one slice per timer tick
+// so the page never freezes, and a query can be dropped with .cancel().
+let queryPumpRunning = false;
+
+function runQueriesInBackground() {
+    if (queryPumpRunning) return;
+    queryPumpRunning = true;
+    const pump = () => {
+        if (Module.runQuerySlice()) {
+            setTimeout(pump, 0);
+        } else {
+            queryPumpRunning = false;
+        }
+    };
+    setTimeout(pump, 0);
+}
+
+// Returns a Promise of {status: 'done' | 'cancelled', results: [...]}
+// with an extra cancel() method. onProgress(0..1) is optional.
+// Falls back to the blocking call if the loaded engine has no async API.
+function getRecommendationsAsync(area, onProgress) {
+    if (!Module.startRecommendationsAsync) {
+        const promise = Promise.resolve({ status: 'done', results: Module.getRecommendations(area) });
+        promise.cancel = () => {};
+        return promise;
+    }
+    let id;
+    const promise = new Promise(resolve => {
+        id = Module.startRecommendationsAsync(area, resolve, onProgress || null);
+    });
+    promise.cancel = () => Module.cancelQuery(id);
+    runQueriesInBackground();
+    return promise;
+}
+
+// Returns a Promise of {status, hospital, distance, path} with cancel()
+function findNearestAsync(area, onProgress) {
+    if (!Module.startNearestAsync) {
+        const result = Module.findNearest(area);
+        const promise = Promise.resolve({ status: 'done', hospital: result.hospital, distance: result.distance, path: result.path });
+        promise.cancel = () => {};
+        return promise;
+    }
+    let id;
+    const promise = new Promise(resolve => {
+        id = Module.startNearestAsync(area, resolve, onProgress || null);
+    });
+    promise.cancel = () => Module.cancelQuery(id);
+    runQueriesInBackground();
+    return promise;
+}
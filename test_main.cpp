@@ -1,8 +1,12 @@
 #include <iostream>
+#include <cmath>
 #include "Disease.h"
 #include "SymptomChecker.h"
 #include "HospitalGraph.h"
 #include "HospitalRecommender.h"
+#include "CoveragePlanner.h"
+#include "MemoryReport.h"
+#include "AsyncQuery.h"
 
 using namespace std;
 
@@ -36,6 +40,31 @@ int main() {
         cout << "- " << r.diseaseName << ": " << r.percentage << "% match" << endl;
     }
 
+    // 2b. TEST WEIGHTED SCORING
+    cout << "\n[Testing Feature 2b: Severity-Weighted Prediction]" << endl;
+    checker.setScoringMode(SEVERITY_WEIGHTED);
+    results = checker.predictDisease(mySymptoms);
+    cout << "Weighted results for 'chest, pain, nausea':" << endl;
+    for(const auto& r : results) {
+        cout << "- " << r.diseaseName << ": " << r.percentage << "%" << endl;
+    }
+    bool ordered = true;
+    for(size_t i = 1; i < results.size(); i++) {
+        if (results[i].percentage > results[i - 1].percentage) ordered = false;
+    }
+    cout << "Listed in order of their percentage: " << (ordered ? "YES" : "NO") << endl;
+
+    vector<string> rareVsCommon = {"Nausea", "Blue skin tint"};
+    results = checker.predictDiseaseTopK(rareVsCommon, 1);
+    cout << "Top-1 for 'Nausea, Blue skin tint': " << results[0].diseaseName << endl;
+
+    // Adding a disease later must be picked up by the model
+    dList.addDisease("Endocarditis", "Infection of the inner lining of the heart.",
+        {"Fever", "Heart murmur", "Blue skin tint"}, {"Dental hygiene"}, 8);
+    results = checker.predictDiseaseTopK(rareVsCommon, 2);
+    cout << "After adding Endocarditis, top-2: " << results[0].diseaseName << ", " << results[1].diseaseName << endl;
+    checker.setScoringMode(MATCH_FRACTION);
+
     // 3. TEST GRAPH
     cout << "\n[Testing Feature 3: Nearest Hospital]" << endl;
     AreaGraph graph;
@@ -56,8 +85,142 @@ int main() {
     
     cout << "Top Recommendations (Lowest Score is Best):" << endl;
     for(const auto& r : recs) {
-        cout << r.data.name << " (" << r.data.fullLocation << ") | Score: " << r.score << " | Dist: " << r.realDistance << "km | Rating: " << r.data.rating << endl;
+        cout << r.data.name << " (" << r.data.fullLocation << ") | Score: " << r.score << " | Dist: " << r.realDistance << "km | Rating: " << r.rating << endl;
+    }
+
+    // 4b. TEST DISTANCE MATRIX
+    cout << "\n[Testing Feature 4b: Precomputed Distance Matrix]" << endl;
+    HospitalRecommender fastRecommender;
+    fastRecommender.enableDistanceMatrix(graph);
+    vector<HospitalScoreWrapper> fastRecs = fastRecommender.getRecommendations("G-10", graph);
+    bool same = fastRecs.size() == recs.size();
+    for(size_t i = 0; same && i < recs.size(); i++) {
+        same = fastRecs[i].data.name == recs[i].data.name && abs(fastRecs[i].realDistance - recs[i].realDistance) < 1e-3;
+    }
+    cout << "Matrix ranking matches Dijkstra ranking: " << (same ? "YES" : "NO") << endl;
+
+    fastRecommender.updateRating("PIMS", 5.0);
+    recommender.updateRating("PIMS", 5.0);
+    fastRecs = fastRecommender.getRecommendations("G-10", graph);
+    cout << "After PIMS rating -> 5.0, second choice: " << fastRecs[1].data.name << " | Score: " << fastRecs[1].score << endl;
+
+    // New road: incremental update must agree with a fresh Dijkstra run
+    graph.addRoad("G-11", "PIMS", 1.0);
+    fastRecs = fastRecommender.getRecommendations("G-11", graph);
+    recs = recommender.getRecommendations("G-11", graph);
+    same = fastRecs.size() == recs.size();
+    for(size_t i = 0; same && i < recs.size(); i++) {
+        same = fastRecs[i].data.name == recs[i].data.name && abs(fastRecs[i].realDistance - recs[i].realDistance) < 1e-3;
+    }
+    cout << "After new road G-11 <-> PIMS, best from G-11: " << fastRecs[0].data.name << " (" << fastRecs[0].realDistance << "km)" << endl;
+    cout << "Incremental matrix matches Dijkstra ranking: " << (same ? "YES" : "NO") << endl;
+
+    vector<HospitalScoreWrapper> topRecs = fastRecommender.getRecommendations("G-11", graph, 3);
+    same = topRecs.size() == 3;
+    for(size_t i = 0; same && i < topRecs.size(); i++) {
+        same = topRecs[i].data.name == fastRecs[i].data.name && topRecs[i].score == fastRecs[i].score;
     }
+    cout << "Top-3 selection matches the full ranking: " << (same ? "YES" : "NO") << endl;
+
+    // 4c. TEST LIVE STATUS SCORING
+    cout << "\n[Testing Feature 4c: Capacity-Aware Scoring]" << endl;
+    BasicHospitalRecommender<CapacityAwareScore> liveRecommender;
+    vector<HospitalScoreWrapper> liveRecs = liveRecommender.getRecommendations("G-10", graph);
+    cout << "Best from G-10 with no status feed: " << liveRecs[0].data.name << " | Score: " << liveRecs[0].score << endl;
+    liveRecommender.applyStatusUpdate({"Maroof International", 0, 45.0f, HOSP_ER_OPEN});
+    liveRecommender.applyStatusUpdate({"PIMS", 12, 10.0f, HOSP_ER_OPEN | HOSP_CARDIAC_UNIT});
+    liveRecs = liveRecommender.getRecommendations("G-10", graph);
+    cout << "Maroof full (0 beds), PIMS has cardiac unit -> Best: " << liveRecs[0].data.name << " | Score: " << liveRecs[0].score << endl;
+
+    // 4d. TEST MEMORY REPORT
+    cout << "\n[Testing Memory Report]" << endl;
+    vector<string_view> uniqueSymptoms = checker.getUniqueSymptoms();
+    const StringPool& pool = dList.getStringPool();
+    cout << "Diseases: " << dList.getCount() << " | Unique symptoms: " << uniqueSymptoms.size()
+         << " | Interned strings: " << pool.getInternedCount() << " | Pool payload: " << pool.payloadBytes() << " bytes" << endl;
+    Disease* angina = dList.getDiseaseDetails("Angina");
+    Disease* heartAttack = dList.getDiseaseDetails("Heart Attack");
+    cout << "'Nausea' stored once: " << (angina->symptoms[3].data() == heartAttack->symptoms[2].data() ? "YES" : "NO") << endl;
+    MemoryReport mem = buildMemoryReport(dList, checker, graph, fastRecommender);
+    cout << "Catalog: " << mem.catalogBytes << " | Symptom index: " << mem.symptomIndexBytes
+         << " | Graph: " << mem.graphBytes << " | Recommender: " << mem.recommenderBytes
+         << " | Total: " << mem.total() << " bytes" << endl;
+
+    // 5. TEST BATCH COVERAGE
+    cout << "\n[Testing Feature 5: Coverage Map (Batch)]" << endl;
+    // Grow the map with a grid of extra sectors so the batch has real work
+    for(int i = 0; i < 30; i++) {
+        for(int j = 0; j < 30; j++) {
+            string node = "Grid-" + to_string(i) + "-" + to_string(j);
+            if(i > 0) graph.addRoad(node, "Grid-" + to_string(i - 1) + "-" + to_string(j), 0.5 + (i * j % 7) * 0.1);
+            if(j > 0) graph.addRoad(node, "Grid-" + to_string(i) + "-" + to_string(j - 1), 0.5 + (i + j) % 5 * 0.1);
+        }
+    }
+    graph.addRoad("Grid-0-0", "G-11", 2.0);
+    graph.addRoad("Grid-29-29", "Saddar", 4.0);
+
+    vector<string> areas = graph.getAreas();
+    WorkStealingPool testPool(4);
+    CoveragePlanner planner(testPool);
+    CoverageReport report = planner.buildCoverage(areas, graph, recommender, true);
+
+    bool batchOk = report.entries.size() == areas.size();
+    for(size_t i = 0; batchOk && i < areas.size(); i++) {
+        PathResult single = graph.findNearestHospital(areas[i]);
+        batchOk = report.entries[i].area == areas[i]
+            && report.entries[i].nearest.hospitalName == single.hospitalName
+            && abs(report.entries[i].nearest.totalDistance - single.totalDistance) < 1e-9;
+    }
+    cout << "Areas: " << areas.size() << " | Workers: " << report.workers << endl;
+    cout << "Batch results match single queries (in input order): " << (batchOk ? "YES" : "NO") << endl;
+    cout << "Parallel: " << report.parallelMs << " ms | Sequential: " << report.sequentialMs
+         << " ms | Speedup: " << report.speedup << "x" << endl;
+
+    // 6. TEST ASYNC QUERIES
+    cout << "\n[Testing Feature 6: Async / Cancellable Queries]" << endl;
+    AsyncQueryEngine engine(50); // small slices so the grid takes many of them
+
+    auto asyncRecs = engine.getRecommendationsAsync("Grid-0-0", graph, recommender);
+    auto asyncNearest = engine.findNearestHospitalAsync("Grid-15-15", graph);
+    engine.runUntilIdle();
+    vector<HospitalScoreWrapper> syncRecs = recommender.getRecommendations("Grid-0-0", graph);
+    PathResult syncNearest = graph.findNearestHospital("Grid-15-15");
+    QueryOutcome<vector<HospitalScoreWrapper>> recOutcome = asyncRecs.getFuture().get();
+    bool asyncOk = recOutcome.status == QUERY_DONE && recOutcome.value.size() == syncRecs.size()
+        && recOutcome.value[0].data.name == syncRecs[0].data.name
+        && asyncNearest.getFuture().get().value.hospitalName == syncNearest.hospitalName;
+    cout << "Async results match sync results: " << (asyncOk ? "YES" : "NO") << endl;
+
+    // A completion listener must already see a ready future
+    bool readyInListener = false;
+    auto listenedQuery = engine.findNearestHospitalAsync("Grid-3-3", graph);
+    listenedQuery.onComplete([&](const QueryOutcome<PathResult>&) {
+        readyInListener = listenedQuery.getFuture().wait_for(chrono::seconds(0)) == future_status::ready;
+    });
+    engine.runUntilIdle();
+    cout << "Future ready inside onComplete listener: " << (readyInListener ? "YES" : "NO") << endl;
+
+    double lastProgress = 0;
+    auto slowQuery = engine.getRecommendationsAsync("Grid-29-29", graph, recommender,
+        [&](double p) { lastProgress = p; });
+    auto liveQuery = engine.getRecommendationsAsync("Grid-0-29", graph, recommender);
+    engine.runSlice();
+    engine.runSlice();
+    engine.runSlice(); // slowQuery now waits behind liveQuery
+    cout << "After 3 slices: pending = " << engine.getPendingCount() << ", progress = " << lastProgress
+         << ", live tasks = " << AsyncQueryEngine::getLiveTaskCount() << endl;
+
+    slowQuery.cancel();
+    engine.runSlice(); // one slice later the work must be gone, even off the front of the queue
+    bool released = slowQuery.getStatus() == QUERY_CANCELLED && engine.getPendingCount() == 1
+        && AsyncQueryEngine::getLiveTaskCount() == 1
+        && slowQuery.getFuture().get().status == QUERY_CANCELLED;
+    cout << "Cancelled query released within one slice: " << (released ? "YES" : "NO") << endl;
+
+    engine.runUntilIdle();
+    bool otherDone = liveQuery.getStatus() == QUERY_DONE && AsyncQueryEngine::getLiveTaskCount() == 0
+        && liveQuery.getFuture().get().value.size() == recommender.getRecommendations("Grid-0-29", graph).size();
+    cout << "Other query still completes: " << (otherDone ? "YES" : "NO") << endl;
 
     return 0;
 }